@@ -0,0 +1,168 @@
+/**
+ * @file profile.h
+ * @author Tereza Burianova, xburia28
+ * @date 18 Oct 2026
+ * @brief Hot-path instrumentation shared by proj1, proj2 and proj3.
+ *
+ * Build a project with -DPROFILE and run it with --profile as the first argument. For every instrumented
+ * stage the number of calls, the total time (monotonic clock), the total cycles (cycle counter) and the
+ * latency percentiles are printed to stderr when the program exits. Stages may be nested, the times are inclusive.
+ * Without -DPROFILE all macros expand to nothing and the program is built exactly as before.
+ * The header has to be included before any other header (it selects the POSIX clock API).
+ */
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#ifdef PROFILE
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define PROF_MAX_STAGES 16
+#define PROF_BUCKETS 64
+
+typedef struct {
+    unsigned long long ns;
+    unsigned long long cycles;
+} ProfSample;
+
+typedef struct {
+    const char *name;
+    unsigned long long count;
+    unsigned long long total_ns;
+    unsigned long long total_cycles;
+    unsigned long long buckets[PROF_BUCKETS];     // bucket b counts the calls taking [2^b, 2^(b+1)) ns
+} ProfStage;
+
+static int prof_enabled = 0;
+static int prof_stage_count = 0;
+static ProfStage prof_stages[PROF_MAX_STAGES];
+
+/* Function prof_cycles:
+ * Return value: current value of the CPU cycle counter, 0 if the architecture has none available
+ */
+static inline unsigned long long prof_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#elif defined(__aarch64__)
+    unsigned long long value;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(value));
+    return value;
+#else
+    return 0;
+#endif
+}
+
+/* Function prof_now:
+ * Return value: current time of the monotonic clock in nanoseconds
+ */
+static inline unsigned long long prof_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (unsigned long long)now.tv_sec * 1000000000ULL + (unsigned long long)now.tv_nsec;
+}
+
+/* Function prof_start:
+ * Return value: ProfSample (starting time and cycle count, zeros if profiling is not enabled)
+ * Functionality: Starts a measurement of a stage.
+ */
+static inline ProfSample prof_start(void) {
+    ProfSample sample = {0, 0};
+    if (prof_enabled) {
+        sample.ns = prof_now();
+        sample.cycles = prof_cycles();
+    }
+    return sample;
+}
+
+/* Function prof_register:
+ * Arguments: const char *name (name of the stage printed in the report)
+ * Return value: index of the new stage, -1 if there are too many stages
+ */
+static inline int prof_register(const char *name) {
+    if (prof_stage_count == PROF_MAX_STAGES)
+        return -1;
+    prof_stages[prof_stage_count].name = name;
+    return prof_stage_count++;
+}
+
+/* Function prof_record:
+ * Arguments: int stage (index of the stage), ProfSample start (value returned by prof_start)
+ * Return value: void
+ * Functionality: Adds one call of the stage to its counters and latency histogram.
+ */
+static inline void prof_record(int stage, ProfSample start) {
+    unsigned long long cycles = prof_cycles() - start.cycles;
+    unsigned long long ns = prof_now() - start.ns;
+    ProfStage *current = &prof_stages[stage];
+    current->count++;
+    current->total_ns += ns;
+    current->total_cycles += cycles;
+    current->buckets[63 - __builtin_clzll(ns | 1)]++;
+}
+
+/* Function prof_percentile:
+ * Arguments: const ProfStage *stage (measured stage), double fraction (wanted percentile, 0.5 for median)
+ * Return value: upper bound of the histogram bucket containing the percentile in nanoseconds
+ */
+static inline unsigned long long prof_percentile(const ProfStage *stage, double fraction) {
+    unsigned long long rank = (unsigned long long)(fraction * stage->count);
+    unsigned long long cumulative = 0;
+    if (rank < stage->count)
+        rank++;
+    for (int b = 0; b < PROF_BUCKETS; b++) {
+        cumulative += stage->buckets[b];
+        if (cumulative >= rank)
+            return (b == PROF_BUCKETS - 1) ? ~0ULL : (2ULL << b);
+    }
+    return 0;
+}
+
+/* Function prof_report:
+ * Return value: void
+ * Functionality: Prints the counters of all stages to stderr (registered by prof_enable to run at exit).
+ */
+static void prof_report(void) {
+    fprintf(stderr, "%-16s %12s %16s %16s %12s %12s %12s\n",
+            "stage", "calls", "total ns", "total cycles", "p50 ns <=", "p90 ns <=", "p99 ns <=");
+    for (int i = 0; i < prof_stage_count; i++) {
+        const ProfStage *stage = &prof_stages[i];
+        fprintf(stderr, "%-16s %12llu %16llu %16llu %12llu %12llu %12llu\n",
+                stage->name, stage->count, stage->total_ns, stage->total_cycles,
+                prof_percentile(stage, 0.50), prof_percentile(stage, 0.90), prof_percentile(stage, 0.99));
+    }
+}
+
+static inline void prof_enable(void) {
+    prof_enabled = 1;
+    atexit(prof_report);
+}
+
+#define PROF_ENABLE() prof_enable()
+#define PROF_START(sample) ProfSample sample = prof_start()
+// the stage is registered on its first measured call, stages are reported in that order
+#define PROF_END(name, sample) do {                         \
+        static int prof_id_ = -2;                           \
+        if (prof_enabled) {                                 \
+            if (prof_id_ == -2)                             \
+                prof_id_ = prof_register(name);             \
+            if (prof_id_ >= 0)                              \
+                prof_record(prof_id_, sample);              \
+        }                                                   \
+    } while (0)
+
+#else
+
+#define PROF_ENABLE() fprintf(stderr, "Profiling is not available, the program has to be compiled with -DPROFILE!\n")
+#define PROF_START(sample)
+#define PROF_END(name, sample) do { } while (0)
+
+#endif
+
+#endif
@@ -4,14 +4,48 @@
  * @date 10 Nov 2019
  */
 
+#include "../profile.h"
 #include <stdio.h>
 #include <string.h>
 
 #define MAXLINE 102
 #define MAXCONTACT 204
+// First UTF-8 lead byte and code point covered by the transliteration table (U+00C0 - U+017F)
+#define LATIN_LEAD 0xC3
+#define LATIN_BASE 0xC0
+
+// T9 digit for every ASCII character, both cases, 0 = keep the character
+static const char asciiT9[128] = {
+    ['a'] = '2', ['b'] = '2', ['c'] = '2', ['A'] = '2', ['B'] = '2', ['C'] = '2',
+    ['d'] = '3', ['e'] = '3', ['f'] = '3', ['D'] = '3', ['E'] = '3', ['F'] = '3',
+    ['g'] = '4', ['h'] = '4', ['i'] = '4', ['G'] = '4', ['H'] = '4', ['I'] = '4',
+    ['j'] = '5', ['k'] = '5', ['l'] = '5', ['J'] = '5', ['K'] = '5', ['L'] = '5',
+    ['m'] = '6', ['n'] = '6', ['o'] = '6', ['M'] = '6', ['N'] = '6', ['O'] = '6',
+    ['p'] = '7', ['q'] = '7', ['r'] = '7', ['s'] = '7', ['P'] = '7', ['Q'] = '7', ['R'] = '7', ['S'] = '7',
+    ['t'] = '8', ['u'] = '8', ['v'] = '8', ['T'] = '8', ['U'] = '8', ['V'] = '8',
+    ['w'] = '9', ['x'] = '9', ['y'] = '9', ['z'] = '9', ['W'] = '9', ['X'] = '9', ['Y'] = '9', ['Z'] = '9',
+    ['+'] = '0'
+};
+
+// T9 digit of the base letter for U+00C0 - U+017F (UTF-8 lead bytes 0xC3 - 0xC5), ' ' = not a letter
+static const char latinT9[] =
+    "2222222233334444"      // U+00C0 ÀÁÂÃÄÅÆÇÈÉÊËÌÍÎÏ
+    "3666666 68888987"      // U+00D0 ÐÑÒÓÔÕÖ×ØÙÚÛÜÝÞß
+    "2222222233334444"      // U+00E0 àáâãäåæçèéêëìíîï
+    "3666666 68888989"      // U+00F0 ðñòóôõö÷øùúûüýþÿ
+    "2222222222222233"      // U+0100 ĀāĂăĄąĆćĈĉĊċČčĎď
+    "3333333333334444"      // U+0110 ĐđĒēĔĕĖėĘęĚěĜĝĞğ
+    "4444444444444444"      // U+0120 ĠġĢģĤĥĦħĨĩĪīĬĭĮį
+    "4444555555555555"      // U+0130 İıĲĳĴĵĶķĸĹĺĻļĽľĿ
+    "5556666666666666"      // U+0140 ŀŁłŃńŅņŇňŉŊŋŌōŎŏ
+    "6666777777777777"      // U+0150 ŐőŒœŔŕŖŗŘřŚśŜŝŞş
+    "7788888888888888"      // U+0160 ŠšŢţŤťŦŧŨũŪūŬŭŮů
+    "8888999999999997";     // U+0170 ŰűŲųŴŵŶŷŸŹźŻżŽžſ
 
 int read_contact(char currentName[], char currentNumber[], char currentContact[], unsigned long *stringLength);
 void uppercase_to_lowercase(char currentContact[], unsigned long *stringLength);
+int latin_index(const char contact[], unsigned long i, unsigned long stringLength);
+unsigned latin_lowercase(unsigned codePoint);
 void convert_to_numbers(char currentContact[], char convertedContact[], unsigned long *stringLength);
 void searchContacts(char convertedContact[], char argument[], int *foundContacts, char currentContact[]);
 
@@ -22,10 +56,19 @@ int main(int argc, char *argv[]) {
     char convertedContact[MAXCONTACT];
     int foundContacts = 0;
     unsigned long stringLength;
+    // Optional timing of the search stages
+    if (argc > 1 && strcmp(argv[1], "--profile") == 0) {
+        PROF_ENABLE();
+        argc--;
+        argv++;
+    }
     // Read all lines of the input
     while (fgets(currentName, MAXLINE, stdin) != NULL) {
         // Read second line of the contact, error handling
-        if (read_contact(currentName, currentNumber, currentContact, &stringLength) == 1) {
+        PROF_START(readStart);
+        int readResult = read_contact(currentName, currentNumber, currentContact, &stringLength);
+        PROF_END("read_contact", readStart);
+        if (readResult == 1) {
             fprintf(stderr, "Function error!");
             return 1;
         }
@@ -36,8 +79,10 @@ int main(int argc, char *argv[]) {
         }
         // Contact search if an argument is available
         if(argc > 1) {
+            PROF_START(convertStart);
             uppercase_to_lowercase(currentContact, &stringLength);
             convert_to_numbers(currentContact, convertedContact, &stringLength);
+            PROF_END("convert", convertStart);
             searchContacts(convertedContact, argv[1], &foundContacts, currentContact);
         } else {
             // No argument available, print all contacts
@@ -65,50 +110,71 @@ void uppercase_to_lowercase(char currentContact[], unsigned long *stringLength)
     for (unsigned long i = 0; i < (*stringLength); i++) {
         if (((int)currentContact[i] >= 65) && ((int)currentContact[i] <= 90)) {
             currentContact[i] += 32;
+        } else if ((unsigned char)currentContact[i] >= 0x80) {
+            // Two-byte UTF-8 letter with diacritics, its lowercase form has the same length
+            int index = latin_index(currentContact, i, *stringLength);
+            if (index < 0)
+                continue;
+            unsigned codePoint = latin_lowercase(LATIN_BASE + index);
+            currentContact[i] = (char)(0xC0 | (codePoint >> 6));
+            currentContact[i+1] = (char)(0x80 | (codePoint & 0x3F));
+            i++;
         }
     }
 }
 
+// Returns the index into latinT9 of the UTF-8 sequence starting at contact[i], -1 if it is not covered
+int latin_index(const char contact[], unsigned long i, unsigned long stringLength) {
+    unsigned char lead = (unsigned char)contact[i];
+    if (lead < LATIN_LEAD || lead > LATIN_LEAD + 2 || i + 1 >= stringLength)
+        return -1;
+    unsigned char next = (unsigned char)contact[i+1];
+    if ((next & 0xC0) != 0x80)
+        return -1;
+    return ((lead - LATIN_LEAD) << 6) | (next & 0x3F);
+}
+
+unsigned latin_lowercase(unsigned codePoint) {
+    // Latin-1 Supplement, uppercase letters are 32 positions before lowercase ones
+    if (codePoint <= 0xDE && codePoint != 0xD7)
+        return codePoint + 32;
+    if (codePoint == 0x178)
+        return 0xFF;
+    // Latin Extended-A, pairs of uppercase and lowercase letters (odd uppercase in the two shifted blocks)
+    if ((codePoint >= 0x139 && codePoint <= 0x148) || (codePoint >= 0x179 && codePoint <= 0x17E))
+        return (codePoint % 2 == 1) ? codePoint + 1 : codePoint;
+    if ((codePoint >= 0x100 && codePoint <= 0x137 && codePoint != 0x130) || (codePoint >= 0x14A && codePoint <= 0x177))
+        return (codePoint % 2 == 0) ? codePoint + 1 : codePoint;
+    return codePoint;
+}
+
 void convert_to_numbers(char currentContact[], char convertedContact[], unsigned long *stringLength) {
-    strcpy(convertedContact, currentContact);
-    // Check every character and convert to corresponding number if necessary
-    for(unsigned long i = 0; i < (*stringLength); i++) {
-        switch (convertedContact[i]) {
-            case 'a': case 'b': case 'c':
-                convertedContact[i] = '2';
-                break;
-            case 'd': case 'e': case 'f':
-                convertedContact[i] = '3';
-                break;
-            case 'g': case 'h': case 'i':
-                convertedContact[i] = '4';
-                break;
-            case 'j': case 'k': case 'l':
-                convertedContact[i] = '5';
-                break;
-            case 'm': case 'n': case 'o':
-                convertedContact[i] = '6';
-                break;
-            case 'p': case 'q': case 'r': case 's':
-                convertedContact[i] = '7';
-                break;
-            case 't': case 'u': case 'v':
-                convertedContact[i] = '8';
-                break;
-            case 'w': case 'x': case 'y': case 'z':
-                convertedContact[i] = '9';
-                break;
-            case '+':
-                convertedContact[i] = '0';
-                break;
+    unsigned long j = 0;
+    // Look up every character in the tables, letters with diacritics become a single digit
+    // The Czech digraph "ch" is typed as c and h on a T9 keypad, so it maps to "24" letter by letter
+    for (unsigned long i = 0; i < (*stringLength); i++) {
+        unsigned char character = (unsigned char)currentContact[i];
+        if (character < 0x80) {
+            convertedContact[j++] = asciiT9[character] ? asciiT9[character] : (char)character;
+            continue;
+        }
+        int index = latin_index(currentContact, i, *stringLength);
+        if (index >= 0 && latinT9[index] != ' ') {
+            convertedContact[j++] = latinT9[index];
+            i++;
+        } else {
+            convertedContact[j++] = (char)character;
         }
     }
+    convertedContact[j] = '\0';
 }
 
 void searchContacts(char convertedContact[], char argument[], int *foundContacts, char currentContact[]) {
+    PROF_START(searchStart);
     // Check if the argument is a substring of the contact
     if (strstr(convertedContact, argument) != NULL) {
         fprintf(stdout, "%s", currentContact);
         *foundContacts = *foundContacts + 1;
     }
+    PROF_END("searchContacts", searchStart);
 }
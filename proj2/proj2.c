@@ -6,12 +6,15 @@
  *
  * The program calculates the voltage and current of a diode in a diode-resistor circuit.
  * The arguments (double values) are the source voltage in volts (u0), the resistor resistance in ohms (r), the needed accuracy in the bisection method (eps)
+ * Optionally preceded by --profile to print the timing of the calculation (program compiled with -DPROFILE).
  */
 
+#include "../profile.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
 #include <errno.h>
+#include <string.h>
 
 #define I0 1e-12
 #define Ut 25.8563e-3
@@ -21,6 +24,12 @@ double diode(double u0, double r, double eps);
 double equation(double u0, double r, double x);
 
 int main(int argc, char *argv[]) {
+    // optional timing of the calculation
+    if (argc > 1 && strcmp(argv[1], "--profile") == 0) {
+        PROF_ENABLE();
+        argc--;
+        argv++;
+    }
     // check the amount of arguments
     if (argc != 4) {
         fprintf(stderr, "3 arguments are needed to run the program (u0, r, eps).\n");
@@ -68,7 +77,10 @@ int argumentsValidity(char *conversionErr1, char *conversionErr2, char *conversi
  * Function: Calculates the difference between Ip (diode current) and Ir (resistor current) used in the bisection method.
  */
 double equation(double u0, double r, double x) {
-    return (I0*(exp(x/Ut)-1)-(u0-x)/r);
+    PROF_START(start);
+    double difference = I0*(exp(x/Ut)-1)-(u0-x)/r;
+    PROF_END("equation", start);
+    return difference;
 }
 
 /* Function diode:
@@ -77,6 +89,7 @@ double equation(double u0, double r, double x) {
  * Function: Calculates the estimated value of Up (diode voltage) using the bisection method.
  */
 double diode(double u0, double r, double eps) {
+    PROF_START(start);
     double a = 0;                                   // left boundary
     double b = u0;                                  // right boundary
     double middle = (a+b)/2;
@@ -96,5 +109,6 @@ double diode(double u0, double r, double eps) {
         if (prev_middle == middle)
             break;
     }
+    PROF_END("diode", start);
     return middle;                                  // estimated value of Up
 }
\ No newline at end of file
@@ -10,8 +10,10 @@
  *   --rpath to solve the maze using the right-hand rule, --lpath to solve the maze using the left-hand rule)
  * * (in case of --lpath, --rpath) entry row, entry column
  * * name of the file containing the maze map
+ * Optionally preceded by --profile to print the timing of the solver (program compiled with -DPROFILE).
  */
 
+#include "../profile.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
@@ -45,6 +47,16 @@ int main(int argc, char *argv[]) {
         fprintf(stderr, "There are too few arguments!\n");
         return 1;
     }
+    // optional timing of the solver
+    if (strcmp(argv[1], "--profile") == 0) {
+        PROF_ENABLE();
+        argc--;
+        argv++;
+        if (argc < 2) {
+            fprintf(stderr, "There are too few arguments!\n");
+            return 1;
+        }
+    }
     Map map;
     int curr_coordinates[2] = {0, 0};
     int hand_rule;
@@ -61,7 +73,10 @@ int main(int argc, char *argv[]) {
     } else {
         return 0;
     }
-    if (load_map(&map, file_name) == 1)
+    PROF_START(loadStart);
+    int loadResult = load_map(&map, file_name);
+    PROF_END("load_map", loadStart);
+    if (loadResult == 1)
         return 1;
     if(curr_coordinates[0] > map.rows || curr_coordinates[0] < 1 || curr_coordinates[1] > map.cols || curr_coordinates[0] < 1) {
         fprintf(stderr, "The cell is not located in the maze (%d rows, %d columns)!\n", map.rows, map.cols);
@@ -127,7 +142,8 @@ int program_response(char argument[], int *hand_rule, int arguments) {
                         "* ./proj3 --help ** opens help to the program\n"
                         "* ./proj3 --test ** checks the map file for invalid values\n"
                         "* ./proj3 --rpath entry_row entry_column filename.txt ** solves the maze, starting with entered cell, using the right-hand rule\n"
-                        "* ./proj3 --lpath entry_row entry_column filename.txt ** solves the maze, starting with entered cell, using the left-hand rule\n");
+                        "* ./proj3 --lpath entry_row entry_column filename.txt ** solves the maze, starting with entered cell, using the left-hand rule\n"
+                        "* ./proj3 --profile ... ** prints the timing of the solver to stderr (program compiled with -DPROFILE)\n");
         return 1;
     } else if(strcmp(argument, "--test") == 0) {
         // TODO - function
@@ -165,6 +181,7 @@ int arguments_validity(char *convertErr1, char *convertErr2) {
  * Functionality: Determines the rotation in the current cell and executes the corresponding movement.
  */
 void cell_movement(Map *map, int curr_coordinates[], int *direction, int direction_increment, int updown) {
+    PROF_START(start);
     int moves[4][2] = {
             {1, 0}, {0, -1}, {-1, 0}, {0, 1}
     };
@@ -193,6 +210,7 @@ void cell_movement(Map *map, int curr_coordinates[], int *direction, int directi
                 curr_coordinates[i] += moves[d_left][i];
             break;
     }
+    PROF_END("cell_movement", start);
 }
 
 /* Function start_border:
@@ -284,6 +302,7 @@ int pathfinding(Map *map, int curr_coordinates[], int hand_rule) {
  * Functionality: Checks a border of a current (r, c) triangle for a wall.
  */
 bool isborder(Map *map, int r, int c, int border) {
+    PROF_START(start);
     // value of the needed cell in the map.cells array
     int value = (int)map->cells[cell_value];
     bool borders[3];
@@ -303,6 +322,7 @@ bool isborder(Map *map, int r, int c, int border) {
         borders[left] = 1;
     else
         borders[left] = 0;
+    PROF_END("isborder", start);
     return borders[border];
 }
 